@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    AutomationTrace records the ChainSettings read by every processBlock()
+    call so a DAW automation pass can be replayed offline.
+
+  ==============================================================================
+*/
+
+#include "AutomationTrace.h"
+
+namespace
+{
+    constexpr int traceMagic = ('E') | ('Q' << 8) | ('T' << 16) | ('R' << 24);
+    constexpr int traceVersion = 1;
+
+    constexpr int truncatedFlag = 1 << 0;
+}
+
+//==============================================================================
+bool AutomationTrace::writeToStream(juce::OutputStream& output) const
+{
+    output.writeInt(traceMagic);
+    output.writeInt(traceVersion);
+    output.writeDouble(sampleRate);
+    output.writeInt(truncated ? truncatedFlag : 0);
+    output.writeInt(static_cast<int>(blocks.size()));
+
+    for (const auto& block : blocks)
+    {
+        const auto& settings = block.chainSettings;
+
+        output.writeInt(block.numSamples);
+        output.writeFloat(settings.lowCutFreq);
+        output.writeFloat(settings.highCutFreq);
+        output.writeFloat(settings.peakFreq);
+        output.writeFloat(settings.peakGainInDecibels);
+        output.writeFloat(settings.peakQuality);
+        output.writeByte(static_cast<char>(settings.lowCutSlope));
+        output.writeByte(static_cast<char>(settings.highCutSlope));
+    }
+
+    output.flush();
+    return output.getStatus().wasOk();
+}
+
+bool AutomationTrace::readFromStream(juce::InputStream& input)
+{
+    if (input.readInt() != traceMagic || input.readInt() != traceVersion)
+        return false;
+
+    sampleRate = input.readDouble();
+    truncated = (input.readInt() & truncatedFlag) != 0;
+    const int numBlocks = input.readInt();
+
+    if (! (sampleRate > 0 && sampleRate <= 1.0e6) || numBlocks < 0)
+        return false;
+
+    // A corrupt block count must not be trusted with a huge allocation
+    const auto totalLength = input.getTotalLength();
+
+    if (totalLength >= 0 && numBlocks > (totalLength - input.getPosition()) / bytesPerBlock)
+        return false;
+
+    blocks.clear();
+    blocks.reserve(static_cast<size_t>(numBlocks));
+
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        // Read each block whole, so one cut short is rejected instead of reading zeros
+        char data[bytesPerBlock];
+
+        if (input.read(data, bytesPerBlock) != bytesPerBlock)
+            return false;
+
+        juce::MemoryInputStream blockInput(data, bytesPerBlock, false);
+        Block block;
+        auto& settings = block.chainSettings;
+
+        auto readSlope = [&blockInput]()
+        {
+            return static_cast<Slope>(juce::jlimit(0, static_cast<int>(Slope_48), static_cast<int>(blockInput.readByte())));
+        };
+
+        block.numSamples = blockInput.readInt();
+        settings.lowCutFreq = blockInput.readFloat();
+        settings.highCutFreq = blockInput.readFloat();
+        settings.peakFreq = blockInput.readFloat();
+        settings.peakGainInDecibels = blockInput.readFloat();
+        settings.peakQuality = blockInput.readFloat();
+        settings.lowCutSlope = readSlope();
+        settings.highCutSlope = readSlope();
+
+        if (block.numSamples <= 0 || block.numSamples > maximumBlockSize)
+            return false;
+
+        blocks.push_back(block);
+    }
+
+    return true;
+}
+
+bool AutomationTrace::writeToFile(const juce::File& file) const
+{
+    file.deleteFile();
+    juce::FileOutputStream output(file);
+
+    return output.openedOk() && writeToStream(output);
+}
+
+bool AutomationTrace::readFromFile(const juce::File& file)
+{
+    juce::FileInputStream input(file);
+
+    return input.openedOk() && readFromStream(input);
+}
+
+//==============================================================================
+void AutomationTraceRecorder::start(double newSampleRate, int maximumNumBlocks)
+{
+    // Allocate before taking the lock, so the audio thread only misses the swap
+    AutomationTrace next;
+    next.sampleRate = newSampleRate;
+    next.blocks.resize(static_cast<size_t>(maximumNumBlocks));
+
+    {
+        const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+        std::swap(next, trace);
+        numRecorded = 0;
+        capacity = maximumNumBlocks;
+        droppedBlocks = false;
+        sampleRate = newSampleRate;
+        capturing = true;
+    }
+}
+
+AutomationTrace AutomationTraceRecorder::stop()
+{
+    const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+    capturing = false;
+    capacity = 0;
+    return takeRecordedBlocks();
+}
+
+AutomationTrace AutomationTraceRecorder::restart()
+{
+    if (! isCapturing())
+        return {};
+
+    AutomationTrace next;
+    next.sampleRate = sampleRate.load();
+    next.blocks.resize(static_cast<size_t>(capacity.load()));
+
+    const juce::SpinLock::ScopedLockType scopedLock(lock);
+
+    auto result = takeRecordedBlocks();
+    std::swap(next, trace);
+
+    return result;
+}
+
+AutomationTrace AutomationTraceRecorder::takeRecordedBlocks()
+{
+    // Called with the lock held
+    AutomationTrace result;
+    std::swap(result, trace);
+
+    result.blocks.resize(static_cast<size_t>(numRecorded.load()));
+    result.truncated = result.truncated || droppedBlocks.exchange(false);
+    numRecorded = 0;
+
+    return result;
+}
+
+void AutomationTraceRecorder::record(double blockSampleRate, int numSamples, const ChainSettings& chainSettings) noexcept
+{
+    // The only work done on the audio thread while no capture is running
+    if (! capturing.load(std::memory_order_relaxed))
+        return;
+
+    const juce::SpinLock::ScopedTryLockType tryLock(lock);
+
+    if (! tryLock.isLocked())
+    {
+        droppedBlocks.store(true, std::memory_order_relaxed);
+        return;
+    }
+
+    if (! capturing.load())
+        return;
+
+    // Only this thread writes numRecorded while capturing, the atomic is for isNearlyFull()
+    const int index = numRecorded.load(std::memory_order_relaxed);
+
+    if (blockSampleRate == trace.sampleRate && index < static_cast<int>(trace.blocks.size()))
+    {
+        trace.blocks[static_cast<size_t>(index)] = { numSamples, chainSettings };
+        numRecorded.store(index + 1, std::memory_order_relaxed);
+    }
+    else
+    {
+        trace.truncated = true;
+    }
+}
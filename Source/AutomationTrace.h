@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    AutomationTrace records the ChainSettings read by every processBlock()
+    call so a DAW automation pass can be replayed offline.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+//==============================================================================
+/**
+    One trace is the sample rate plus, for every processed block, its size and
+    the settings returned by getChainSettings().
+
+    File layout (little endian): "EQTR", version, sample rate (double), flags
+    (int32), number of blocks, then per block the sample count (int32), the
+    five float parameters and the two slopes (one byte each) - 26 bytes per block.
+*/
+struct AutomationTrace
+{
+    static constexpr int bytesPerBlock = 26;
+
+    // Anything larger in a file is treated as corruption
+    static constexpr int maximumBlockSize = 1 << 16;
+
+    struct Block
+    {
+        int numSamples { 0 };
+        ChainSettings chainSettings;
+    };
+
+    double sampleRate { 0 };
+    std::vector<Block> blocks;
+
+    // Set when blocks were dropped because the capture was full or the sample rate changed
+    bool truncated { false };
+
+    bool writeToStream(juce::OutputStream& output) const;
+    bool readFromStream(juce::InputStream& input);
+
+    bool writeToFile(const juce::File& file) const;
+    bool readFromFile(const juce::File& file);
+};
+
+//==============================================================================
+/**
+    Fills a preallocated AutomationTrace from the audio thread.
+
+    start(), restart() and stop() are called from the message thread and may
+    allocate. record() never allocates or blocks, and is a single relaxed load
+    while no capture is running. If the trace is full the block is dropped and
+    the trace is marked as truncated, so the caller should poll isNearlyFull()
+    and restart() to hand the blocks over without a gap. A block that arrives
+    while the message thread holds the lock is dropped and marks the trace as
+    truncated too. Blocks at another sample rate than the one passed to start()
+    are dropped the same way, so when the rate changes the caller should stop()
+    and start() a new trace, see getSampleRate().
+*/
+class AutomationTraceRecorder
+{
+public:
+    AutomationTraceRecorder() = default;
+
+    void start(double newSampleRate, int maximumNumBlocks);
+    AutomationTrace stop();
+
+    // Returns the blocks recorded so far and carries on into an empty trace of the same size
+    AutomationTrace restart();
+
+    bool isCapturing() const noexcept { return capturing.load(); }
+
+    // True once three quarters of the trace are used, leaving time to restart() before it fills
+    bool isNearlyFull() const noexcept { return numRecorded.load(std::memory_order_relaxed) >= capacity.load(std::memory_order_relaxed) / 4 * 3; }
+
+    // The sample rate of the current capture, to detect a change before recording at the new one
+    double getSampleRate() const noexcept { return sampleRate.load(); }
+
+    void record(double blockSampleRate, int numSamples, const ChainSettings& chainSettings) noexcept;
+
+private:
+    juce::SpinLock lock;
+    AutomationTrace trace;
+    std::atomic<int> numRecorded { 0 }, capacity { 0 };
+    std::atomic<bool> capturing { false }, droppedBlocks { false };
+    std::atomic<double> sampleRate { 0 };
+
+    AutomationTrace takeRecordedBlocks();
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutomationTraceRecorder)
+};
@@ -0,0 +1,53 @@
+/*
+  ==============================================================================
+
+    ChainSettings and the coefficient design for each link of the chain.
+    Kept apart from PluginProcessor.h so EQRack can be used without the
+    processor and its AudioProcessorValueTreeState.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+enum Slope
+{
+    Slope_12,
+    Slope_24,
+    Slope_36,
+    Slope_48
+};
+
+struct ChainSettings
+{
+    float peakFreq{0}, peakGainInDecibels{0}, peakQuality{1.f};
+    float lowCutFreq{0}, highCutFreq{0};
+    Slope lowCutSlope{Slope::Slope_12}, highCutSlope{Slope::Slope_12};
+};
+
+/* Coefficient design for each link of the chain, shared by the processor and
+   the multi-track EQRack so both produce identical filters from a ChainSettings */
+inline juce::dsp::IIR::Coefficients<float>::Ptr makePeakFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate, chainSettings.peakFreq, chainSettings.peakQuality, juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+}
+
+inline juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeLowCutFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    /* Function creates one IIR Coefficient for every 2 orders (See function implementation).
+     Order represents slope. CutFilter has 4 Filters and requires 4 IIR Coefficients. So, the
+     order for 1st slope should be 2, for 2nd slope should be 4 etc.
+     Slope Choice 0: 12 dB/oct -> order:2
+     Slope Choice 1: 12 dB/oct -> order:4
+     Slope Choice 2: 12 dB/oct -> order:6
+     Slope Choice 3: 12 dB/oct -> order:8
+     Thus, 3rd argument of the function is calculated as "order = 2 * (slope + 1)"  */
+    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq, sampleRate, 2 * (chainSettings.lowCutSlope + 1));
+}
+
+inline juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeHighCutFilter(const ChainSettings& chainSettings, double sampleRate)
+{
+    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq, sampleRate, 2 * (chainSettings.highCutSlope + 1));
+}
@@ -0,0 +1,202 @@
+/*
+  ==============================================================================
+
+    EQRack hosts many independent SimpleEQ chains (one per track) and
+    processes them side by side, one track per SIMD lane.
+
+  ==============================================================================
+*/
+
+#include "EQRack.h"
+
+//==============================================================================
+void EQRack::prepare(double newSampleRate, int newMaximumBlockSize, int newNumTracks)
+{
+    sampleRate = newSampleRate;
+    maximumBlockSize = newMaximumBlockSize;
+    numTracks = newNumTracks;
+
+    const int numGroups = (numTracks + lanesPerGroup - 1) / lanesPerGroup;
+
+    groups.assign(static_cast<size_t>(numGroups), Group{});
+    frames.assign(static_cast<size_t>(maximumBlockSize), Lanes{});
+    bypassed.assign(static_cast<size_t>(numTracks), false);
+
+    // Unused lanes of the last group stay as pass-through stages fed with silence
+    for (int track = 0; track < numGroups * lanesPerGroup; ++track)
+        for (int stage = 0; stage < numStages; ++stage)
+            setStageBypassed(track, stage);
+
+   #if EQRACK_AVX2_DISPATCH
+    if (juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3())
+        processStageFunction = processStageAVX2;
+   #endif
+}
+
+void EQRack::reset()
+{
+    for (auto& group : groups)
+    {
+        std::fill(&group.state1[0][0], &group.state1[0][0] + 2 * numStages, Lanes{});
+        std::fill(&group.state2[0][0], &group.state2[0][0] + 2 * numStages, Lanes{});
+    }
+}
+
+void EQRack::setTrackSettings(int trackIndex, const ChainSettings& chainSettings)
+{
+    jassert(juce::isPositiveAndBelow(trackIndex, numTracks));
+
+    updateCutStages(trackIndex, 0, makeLowCutFilter(chainSettings, sampleRate), chainSettings.lowCutSlope);
+    setStage(trackIndex, peakStage, makePeakFilter(chainSettings, sampleRate));
+    updateCutStages(trackIndex, highCutStage, makeHighCutFilter(chainSettings, sampleRate), chainSettings.highCutSlope);
+}
+
+void EQRack::setTrackBypassed(int trackIndex, bool shouldBeBypassed)
+{
+    jassert(juce::isPositiveAndBelow(trackIndex, numTracks));
+    bypassed[static_cast<size_t>(trackIndex)] = shouldBeBypassed;
+}
+
+bool EQRack::isTrackBypassed(int trackIndex) const
+{
+    jassert(juce::isPositiveAndBelow(trackIndex, numTracks));
+    return bypassed[static_cast<size_t>(trackIndex)];
+}
+
+void EQRack::setStage(int trackIndex, int stage, const Coefficients& coefficients)
+{
+    // Every link of the chain is a biquad: b0, b1, b2, a1, a2 with a0 normalised to 1
+    jassert(coefficients->coefficients.size() == 5);
+
+    const auto* raw = coefficients->getRawCoefficients();
+    auto& target = groups[static_cast<size_t>(trackIndex / lanesPerGroup)].stages[stage];
+    const int lane = trackIndex % lanesPerGroup;
+
+    target.b0.v[lane] = raw[0];
+    target.b1.v[lane] = raw[1];
+    target.b2.v[lane] = raw[2];
+    target.a1.v[lane] = raw[3];
+    target.a2.v[lane] = raw[4];
+    target.active.v[lane] = 1.f;
+    target.bypassed.v[lane] = 0.f;
+}
+
+void EQRack::setStageBypassed(int trackIndex, int stage)
+{
+    // Coefficients and state are left alone, as ProcessorChain::setBypassed() does
+    auto& target = groups[static_cast<size_t>(trackIndex / lanesPerGroup)].stages[stage];
+    const int lane = trackIndex % lanesPerGroup;
+
+    target.active.v[lane] = 0.f;
+    target.bypassed.v[lane] = 1.f;
+}
+
+//==============================================================================
+JUCE_FORCEDINLINE void EQRack::processStageLanes(Lanes* frames, int numSamples, const Stage& stage, Lanes& s1, Lanes& s2) noexcept
+{
+    // Local copies keep coefficients and state in registers for the whole block
+    const auto b0 = stage.b0, b1 = stage.b1, b2 = stage.b2, a1 = stage.a1, a2 = stage.a2;
+    const auto active = stage.active, bypassed = stage.bypassed;
+    auto z1 = s1, z2 = s2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto& frame = frames[i];
+
+        // Same recurrence as juce::dsp::IIR::Filter, one track per lane
+        for (int lane = 0; lane < lanesPerGroup; ++lane)
+        {
+            const auto input = frame.v[lane];
+            const auto output = b0.v[lane] * input + z1.v[lane];
+            const auto next1 = b1.v[lane] * input - a1.v[lane] * output + z2.v[lane];
+            const auto next2 = b2.v[lane] * input - a2.v[lane] * output;
+
+            /* Blend by the 1/0 masks instead of branching so the loop still vectorises.
+               One term is always multiplied by 0, so the result is exact either way */
+            z1.v[lane] = active.v[lane] * next1 + bypassed.v[lane] * z1.v[lane];
+            z2.v[lane] = active.v[lane] * next2 + bypassed.v[lane] * z2.v[lane];
+            frame.v[lane] = active.v[lane] * output + bypassed.v[lane] * input;
+        }
+    }
+
+    s1 = z1;
+    s2 = z2;
+}
+
+void EQRack::processStage(Lanes* frames, int numSamples, const Stage& stage, Lanes& s1, Lanes& s2) noexcept
+{
+    processStageLanes(frames, numSamples, stage, s1, s2);
+}
+
+#if EQRACK_AVX2_DISPATCH
+// Same loop, inlined into a function the compiler may use 256-bit AVX2 and FMA for
+__attribute__((target("avx2,fma")))
+void EQRack::processStageAVX2(Lanes* frames, int numSamples, const Stage& stage, Lanes& s1, Lanes& s2) noexcept
+{
+    processStageLanes(frames, numSamples, stage, s1, s2);
+}
+#endif
+
+void EQRack::process(juce::AudioBuffer<float>* const* trackBuffers, int numSamples)
+{
+    // prepare() has not been called
+    jassert(maximumBlockSize > 0);
+
+    if (maximumBlockSize <= 0)
+        return;
+
+    juce::ScopedNoDenormals noDenormals;
+
+    for (int startSample = 0; startSample < numSamples; startSample += maximumBlockSize)
+        processChunk(trackBuffers, startSample, juce::jmin(maximumBlockSize, numSamples - startSample));
+}
+
+void EQRack::processChunk(juce::AudioBuffer<float>* const* trackBuffers, int startSample, int numSamples)
+{
+    for (size_t groupIndex = 0; groupIndex < groups.size(); ++groupIndex)
+    {
+        auto& group = groups[groupIndex];
+        const int firstTrack = static_cast<int>(groupIndex) * lanesPerGroup;
+        const int tracksInGroup = juce::jmin(lanesPerGroup, numTracks - firstTrack);
+
+        // Left and right of every track share the coefficients but not the state
+        for (int channel = 0; channel < 2; ++channel)
+        {
+            // Transpose the group into lane-major frames
+            for (int lane = 0; lane < lanesPerGroup; ++lane)
+            {
+                if (lane < tracksInGroup)
+                {
+                    auto* buffer = trackBuffers[firstTrack + lane];
+                    jassert(buffer->getNumChannels() >= 2 && buffer->getNumSamples() >= startSample + numSamples);
+
+                    const auto* input = buffer->getReadPointer(channel, startSample);
+
+                    for (int i = 0; i < numSamples; ++i)
+                        frames[static_cast<size_t>(i)].v[lane] = input[i];
+                }
+                else
+                {
+                    for (int i = 0; i < numSamples; ++i)
+                        frames[static_cast<size_t>(i)].v[lane] = 0.f;
+                }
+            }
+
+            for (int stage = 0; stage < numStages; ++stage)
+                processStageFunction(frames.data(), numSamples, group.stages[stage],
+                                     group.state1[channel][stage], group.state2[channel][stage]);
+
+            // Transpose back, leaving bypassed tracks untouched
+            for (int lane = 0; lane < tracksInGroup; ++lane)
+            {
+                if (bypassed[static_cast<size_t>(firstTrack + lane)])
+                    continue;
+
+                auto* output = trackBuffers[firstTrack + lane]->getWritePointer(channel, startSample);
+
+                for (int i = 0; i < numSamples; ++i)
+                    output[i] = frames[static_cast<size_t>(i)].v[lane];
+            }
+        }
+    }
+}
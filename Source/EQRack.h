@@ -0,0 +1,151 @@
+/*
+  ==============================================================================
+
+    EQRack hosts many independent SimpleEQ chains (one per track) and
+    processes them side by side, one track per SIMD lane.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ChainSettings.h"
+
+/* GCC and Clang x86 builds that don't already target AVX2 also compile the stage
+   loop for AVX2 + FMA and pick that version at runtime when the CPU has it */
+#if (JUCE_GCC || JUCE_CLANG) && JUCE_INTEL && ! defined(__AVX2__)
+ #define EQRACK_AVX2_DISPATCH 1
+#else
+ #define EQRACK_AVX2_DISPATCH 0
+#endif
+
+//==============================================================================
+/**
+    Each track of the rack is the equivalent of one SimpleEQAudioProcessor:
+    a stereo pair of LowCut -> Peak -> HighCut chains driven by a ChainSettings.
+
+    Tracks are packed into groups of lanesPerGroup. Inside a group every
+    coefficient and every filter state is stored lane-major (one float per
+    track, contiguous), so the inner loops run across tracks and the compiler
+    vectorises them. The real vector width depends on the build:
+    - 8 lanes by default. One 256-bit instruction per 8 tracks with the AVX2
+      dispatch above or an AVX2 build, otherwise two 128-bit SSE instructions
+      (e.g. MSVC without /arch:AVX2).
+    - 16 lanes when the build enables AVX-512 (-mavx512f, /arch:AVX512).
+
+    setTrackSettings() and setTrackBypassed() write the same arrays process()
+    reads without any locking. Call them on the audio thread between process()
+    calls, never concurrently with it.
+*/
+class EQRack
+{
+public:
+   #if defined(__AVX512F__)
+    static constexpr int lanesPerGroup = 16;
+   #else
+    static constexpr int lanesPerGroup = 8;
+   #endif
+
+    EQRack() = default;
+
+    //==============================================================================
+    /* Allocates every group and clears the filter state. Every track passes
+       audio through unchanged until setTrackSettings() is called for it */
+    void prepare(double sampleRate, int maximumBlockSize, int numTracks);
+    void reset();
+
+    int getNumTracks() const noexcept { return numTracks; }
+
+    /* Designs the coefficients of one track with the same functions as the
+       processor. Call it when the track's settings change, on the thread that
+       calls process() */
+    void setTrackSettings(int trackIndex, const ChainSettings& chainSettings);
+
+    /* A bypassed track passes its input through untouched */
+    void setTrackBypassed(int trackIndex, bool shouldBeBypassed);
+    bool isTrackBypassed(int trackIndex) const;
+
+    /* Processes one block in place for every track. trackBuffers holds
+       getNumTracks() stereo buffers with at least numSamples samples each.
+       Blocks longer than the maximumBlockSize passed to prepare() are
+       processed in several chunks */
+    void process(juce::AudioBuffer<float>* const* trackBuffers, int numSamples);
+
+private:
+    // 4 LowCut links -> Peak -> 4 HighCut links, same as MonoChain
+    static constexpr int numStages = 9;
+    static constexpr int peakStage = 4;
+    static constexpr int highCutStage = 5;
+
+    struct alignas(sizeof(float) * lanesPerGroup) Lanes
+    {
+        float v[lanesPerGroup];
+    };
+
+    // Normalised biquad coefficients, same layout as juce::dsp::IIR::Coefficients
+    struct Stage
+    {
+        Lanes b0, b1, b2, a1, a2;
+
+        /* 1 and 0 for an active link, 0 and 1 for a bypassed one. A bypassed link
+           passes its input and keeps its state frozen, like a bypassed link of a
+           juce::dsp::ProcessorChain, so raising a slope again resumes from it */
+        Lanes active, bypassed;
+    };
+
+    struct Group
+    {
+        Stage stages[numStages];
+
+        // Transposed Direct Form II state, [channel][stage]
+        Lanes state1[2][numStages], state2[2][numStages];
+    };
+
+    std::vector<Group> groups;
+
+    // One frame per sample holding the current channel of every track in a group
+    std::vector<Lanes> frames;
+
+    std::vector<bool> bypassed;
+
+    double sampleRate { 44100.0 };
+    int maximumBlockSize { 0 };
+    int numTracks { 0 };
+
+    using Coefficients = juce::dsp::IIR::Coefficients<float>::Ptr;
+
+    void setStage(int trackIndex, int stage, const Coefficients& coefficients);
+    void setStageBypassed(int trackIndex, int stage);
+
+    template<typename CoefficientType>
+    void updateCutStages(int trackIndex, int firstStage,
+                         const CoefficientType& cutCoefficients,
+                         const Slope& slope)
+    {
+        // Links beyond the selected slope are bypassed, like updateCutFilter()
+        for (int i = 0; i < 4; ++i)
+        {
+            if (i <= static_cast<int>(slope))
+                setStage(trackIndex, firstStage + i, cutCoefficients[i]);
+            else
+                setStageBypassed(trackIndex, firstStage + i);
+        }
+    }
+
+    using StageFunction = void (*)(Lanes* frames, int numSamples, const Stage& stage, Lanes& s1, Lanes& s2) noexcept;
+
+    static void processStageLanes(Lanes* frames, int numSamples, const Stage& stage, Lanes& s1, Lanes& s2) noexcept;
+    static void processStage(Lanes* frames, int numSamples, const Stage& stage, Lanes& s1, Lanes& s2) noexcept;
+   #if EQRACK_AVX2_DISPATCH
+    static void processStageAVX2(Lanes* frames, int numSamples, const Stage& stage, Lanes& s1, Lanes& s2) noexcept;
+   #endif
+
+    StageFunction processStageFunction { processStage };
+
+    // numSamples is at most maximumBlockSize, the size of frames
+    void processChunk(juce::AudioBuffer<float>* const* trackBuffers, int startSample, int numSamples);
+
+    //==============================================================================
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (EQRack)
+};
@@ -8,6 +8,60 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "AutomationTrace.h"
+
+/* Build with SIMPLEEQ_CAPTURE_AUTOMATION=1 to record an automation trace of every
+   instance from prepareToPlay() until releaseResources() or deletion. Traces are
+   written to "SimpleEQ Traces" in the user's documents folder, a new file whenever
+   the buffer fills up, and can be replayed with TraceReplay */
+#ifndef SIMPLEEQ_CAPTURE_AUTOMATION
+ #define SIMPLEEQ_CAPTURE_AUTOMATION 0
+#endif
+
+/* The capture buffer holds SIMPLEEQ_CAPTURE_SECONDS of audio in blocks of
+   SIMPLEEQ_CAPTURE_MINIMUM_BLOCK_SIZE samples. Hosts may split blocks far below
+   the size announced to prepareToPlay(), so that size is not used */
+#ifndef SIMPLEEQ_CAPTURE_SECONDS
+ #define SIMPLEEQ_CAPTURE_SECONDS 60
+#endif
+
+#ifndef SIMPLEEQ_CAPTURE_MINIMUM_BLOCK_SIZE
+ #define SIMPLEEQ_CAPTURE_MINIMUM_BLOCK_SIZE 32
+#endif
+
+#if SIMPLEEQ_CAPTURE_AUTOMATION
+namespace
+{
+    // How often the message thread checks whether the capture buffer needs writing out
+    constexpr int traceFlushIntervalMs = 1000;
+
+    class TraceFlushTimer  : public juce::Timer
+    {
+    public:
+        explicit TraceFlushTimer(std::function<void()> callbackToUse) : callback(std::move(callbackToUse)) {}
+
+        void timerCallback() override { callback(); }
+
+    private:
+        std::function<void()> callback;
+    };
+
+    void writeCapturedTrace(const AutomationTrace& trace)
+    {
+        auto folder = juce::File::getSpecialLocation(juce::File::userDocumentsDirectory).getChildFile("SimpleEQ Traces");
+
+        if (trace.blocks.empty() || ! folder.createDirectory().wasOk())
+            return;
+
+        auto file = folder.getNonexistentChildFile("trace", ".eqtrace");
+
+        if (! trace.writeToFile(file))
+            juce::Logger::writeToLog("SimpleEQ: could not write " + file.getFullPathName());
+        else if (trace.truncated)
+            juce::Logger::writeToLog("SimpleEQ: " + file.getFullPathName() + " is truncated, some blocks were dropped");
+    }
+}
+#endif
 
 //==============================================================================
 SimpleEQAudioProcessor::SimpleEQAudioProcessor()
@@ -22,10 +76,26 @@ SimpleEQAudioProcessor::SimpleEQAudioProcessor()
                        )
 #endif
 {
+   #if SIMPLEEQ_CAPTURE_AUTOMATION
+    // Write the trace out before it fills, instead of dropping blocks until deletion
+    traceFlushTimer = std::make_unique<TraceFlushTimer>([this]
+    {
+        if (isCapturingTrace() && traceRecorder->isNearlyFull())
+            writeCapturedTrace(traceRecorder->restart());
+    });
+
+    traceFlushTimer->startTimer(traceFlushIntervalMs);
+   #endif
 }
 
 SimpleEQAudioProcessor::~SimpleEQAudioProcessor()
 {
+   #if SIMPLEEQ_CAPTURE_AUTOMATION
+    traceFlushTimer.reset();
+
+    if (isCapturingTrace())
+        writeCapturedTrace(stopTraceCapture());
+   #endif
 }
 
 //==============================================================================
@@ -112,12 +182,27 @@ void SimpleEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlo
     
     updateFilters();
 
+   #if SIMPLEEQ_CAPTURE_AUTOMATION
+    // A trace holds a single sample rate, so a rate change starts a new file
+    if (isCapturingTrace() && traceRecorder->getSampleRate() != sampleRate)
+        writeCapturedTrace(stopTraceCapture());
+
+    if (! isCapturingTrace())
+        startTraceCapture(static_cast<int>(sampleRate * SIMPLEEQ_CAPTURE_SECONDS / SIMPLEEQ_CAPTURE_MINIMUM_BLOCK_SIZE));
+   #endif
+
 }
 
 void SimpleEQAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+
+   #if SIMPLEEQ_CAPTURE_AUTOMATION
+    // prepareToPlay() starts a new trace, so a crash later on doesn't lose this one
+    if (isCapturingTrace())
+        writeCapturedTrace(stopTraceCapture());
+   #endif
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -176,7 +261,13 @@ void SimpleEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     }
     */
     
-    updateFilters();
+    auto chainSettings = getChainSettings(apvts);
+
+    // Does nothing unless a trace capture has been started
+    if (auto* recorder = activeTraceRecorder.load(std::memory_order_acquire))
+        recorder->record(getSampleRate(), buffer.getNumSamples(), chainSettings);
+
+    updateFilters(chainSettings);
     
     juce::dsp::AudioBlock<float> block(buffer);
 
@@ -255,9 +346,33 @@ ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts)
     return settings;
 }
 
+void applyChainSettings(juce::AudioProcessorValueTreeState& apvts, const ChainSettings& chainSettings)
+{
+    auto setParameter = [&apvts](const juce::String& parameterID, float value)
+    {
+        if (auto* parameter = apvts.getParameter(parameterID))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    };
+
+    setParameter("LowCut Freq", chainSettings.lowCutFreq);
+    setParameter("HighCut Freq", chainSettings.highCutFreq);
+    setParameter("Peak Freq", chainSettings.peakFreq);
+    setParameter("Peak Gain", chainSettings.peakGainInDecibels);
+    setParameter("Peak Quality", chainSettings.peakQuality);
+    setParameter("LowCut Slope", static_cast<float>(chainSettings.lowCutSlope));
+    setParameter("HighCut Slope", static_cast<float>(chainSettings.highCutSlope));
+}
+
+void prepareForOfflineProcessing(SimpleEQAudioProcessor& processor, double sampleRate, int samplesPerBlock)
+{
+    // A host calls this before prepareToPlay(), updateFilters() designs with getSampleRate()
+    processor.setRateAndBufferSizeDetails(sampleRate, samplesPerBlock);
+    processor.prepareToPlay(sampleRate, samplesPerBlock);
+}
+
 void SimpleEQAudioProcessor::updatePeakFilter(const ChainSettings& chainSettings)
 {
-    auto peakCoefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(getSampleRate(), chainSettings.peakFreq, chainSettings.peakQuality, juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+    auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate());
     
     // Assign Coefficients to Filters
     updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
@@ -275,19 +390,10 @@ void SimpleEQAudioProcessor::updateCoefficients(Coefficients& old, const Coeffic
 
 void SimpleEQAudioProcessor::updateLowCutFilters(const ChainSettings &chainSettings)
 {
-    /* Function creates one IIR Coefficient for every 2 orders (See function implementation).
-     Order represents slope. CutFilter has 4 Filters and requires 4 IIR Coefficients. So, the
-     order for 1st slope should be 2, for 2nd slope should be 4 etc.
-     Slope Choice 0: 12 dB/oct -> order:2
-     Slope Choice 1: 12 dB/oct -> order:4
-     Slope Choice 2: 12 dB/oct -> order:6
-     Slope Choice 3: 12 dB/oct -> order:8
-     Thus, 3rd argument of the function is calculated as "order = 2 * (slope + 1)"  */
-    
     /*
      Initialize leftChain
      */
-    auto lowCutCoefficients = juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(chainSettings.lowCutFreq, getSampleRate(), 2 * (chainSettings.lowCutSlope + 1));
+    auto lowCutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
     
     // Get left and right LowCut CutFilter
     auto& leftLowCut = leftChain.get<ChainPositions::LowCut>(); // CutFilter&
@@ -302,7 +408,7 @@ void SimpleEQAudioProcessor::updateHighCutFilters(const ChainSettings &chainSett
     /*
      Initialize rightChain
      */
-    auto highCutCoefficients = juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(chainSettings.highCutFreq, getSampleRate(), 2 * (chainSettings.highCutSlope + 1));
+    auto highCutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
     
     // Get left and right HighCut CutFilter
     auto& leftHighCut = leftChain.get<ChainPositions::HighCut>();
@@ -315,14 +421,42 @@ void SimpleEQAudioProcessor::updateHighCutFilters(const ChainSettings &chainSett
 void SimpleEQAudioProcessor::updateFilters()
 {
     // Producing Coefficients
-    auto chainSettings = getChainSettings(apvts);
-    
+    updateFilters(getChainSettings(apvts));
+}
+
+void SimpleEQAudioProcessor::updateFilters(const ChainSettings& chainSettings)
+{
     updateLowCutFilters(chainSettings);
     
     // Peak Filter Configuration
     updatePeakFilter(chainSettings);
     
     updateHighCutFilters(chainSettings);
+
+    /* A plain load and store: the audio thread is the only writer while playing,
+       so a locked read-modify-write would only slow down the path being measured */
+    numCoefficientRedesigns.store(numCoefficientRedesigns.load(std::memory_order_relaxed) + 3, std::memory_order_relaxed);
+}
+
+void SimpleEQAudioProcessor::startTraceCapture(int maximumNumBlocks)
+{
+    if (traceRecorder == nullptr)
+        traceRecorder = std::make_unique<AutomationTraceRecorder>();
+
+    traceRecorder->start(getSampleRate(), maximumNumBlocks);
+
+    // The recorder lives as long as the processor once published
+    activeTraceRecorder.store(traceRecorder.get(), std::memory_order_release);
+}
+
+AutomationTrace SimpleEQAudioProcessor::stopTraceCapture()
+{
+    return traceRecorder != nullptr ? traceRecorder->stop() : AutomationTrace();
+}
+
+bool SimpleEQAudioProcessor::isCapturingTrace() const
+{
+    return traceRecorder != nullptr && traceRecorder->isCapturing();
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout SimpleEQAudioProcessor::createParameterLayout()
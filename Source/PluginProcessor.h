@@ -9,23 +9,15 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "ChainSettings.h"
 
-enum Slope
-{
-    Slope_12,
-    Slope_24,
-    Slope_36,
-    Slope_48
-};
+ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts); 
 
-struct ChainSettings
-{
-    float peakFreq{0}, peakGainInDecibels{0}, peakQuality{1.f};
-    float lowCutFreq{0}, highCutFreq{0};
-    Slope lowCutSlope{Slope::Slope_12}, highCutSlope{Slope::Slope_12};
-};
+// Inverse of getChainSettings(): sets every parameter so it reads back the given settings
+void applyChainSettings(juce::AudioProcessorValueTreeState& apvts, const ChainSettings& chainSettings);
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState& apvts); 
+struct AutomationTrace;
+class AutomationTraceRecorder;
 
 //==============================================================================
 /**
@@ -74,6 +66,19 @@ public:
     
     juce::AudioProcessorValueTreeState apvts = juce::AudioProcessorValueTreeState(*this, nullptr, "Parameters", createParameterLayout());
 
+    /* Automation trace capture: records the block size and ChainSettings of every
+       processBlock() call, up to maximumNumBlocks, until stopTraceCapture().
+       Call these from the message thread. Blocks that don't fit, or that arrive
+       at another sample rate than the one captured, mark the trace as truncated */
+    void startTraceCapture(int maximumNumBlocks);
+    AutomationTrace stopTraceCapture();
+    bool isCapturingTrace() const;
+
+    /* Number of filter coefficient sets designed so far (LowCut, Peak and HighCut count
+       separately). Every update redesigns all three today, so this is always 3 per
+       processBlock() plus 3 per prepareToPlay()/setStateInformation() */
+    juce::int64 getNumCoefficientRedesigns() const noexcept { return numCoefficientRedesigns.load(std::memory_order_relaxed); }
+
 private:
 
     // Type aliasing - Only Float filters for this project
@@ -158,9 +163,23 @@ private:
     void updateHighCutFilters(const ChainSettings& chainSettings);
     
     void updateFilters();
+    void updateFilters(const ChainSettings& chainSettings);
+
+    std::atomic<juce::int64> numCoefficientRedesigns { 0 };
+
+    // Only created by the first startTraceCapture(), processBlock() reads it through activeTraceRecorder
+    std::unique_ptr<AutomationTraceRecorder> traceRecorder;
+    std::atomic<AutomationTraceRecorder*> activeTraceRecorder { nullptr };
+
+    // Writes out a trace that is nearly full, only created in SIMPLEEQ_CAPTURE_AUTOMATION builds
+    std::unique_ptr<juce::Timer> traceFlushTimer;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleEQAudioProcessor)
 };
 
+/* Prepares a processor that runs outside a plugin host (benchmarks, tests, trace
+   replay), where nothing else sets the sample rate that getSampleRate() returns */
+void prepareForOfflineProcessing(SimpleEQAudioProcessor& processor, double sampleRate, int samplesPerBlock);
+
 
@@ -0,0 +1,193 @@
+/*
+  ==============================================================================
+
+    TraceReplay drives SimpleEQAudioProcessor from an automation trace as fast
+    as possible and reports how long each block took.
+
+    Usage: TraceReplay <trace.eqtrace> [--audio <file>] [--repeat <count>]
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+#include "../../../Source/AutomationTrace.h"
+
+namespace
+{
+    // Stereo input for the replay: a file if one was given, otherwise white noise
+    juce::AudioBuffer<float> loadInputAudio(const juce::File& audioFile, int minimumNumSamples)
+    {
+        juce::AudioBuffer<float> audio;
+
+        if (audioFile != juce::File())
+        {
+            juce::AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
+
+            std::unique_ptr<juce::AudioFormatReader> reader { formatManager.createReaderFor(audioFile) };
+
+            if (reader != nullptr && reader->lengthInSamples > 0)
+            {
+                const auto numSamples = static_cast<int>(reader->lengthInSamples);
+                audio.setSize(2, numSamples);
+
+                // A mono file is read into both channels
+                reader->read(&audio, 0, numSamples, 0, true, true);
+                return audio;
+            }
+
+            std::cerr << "Could not read " << audioFile.getFullPathName() << ", using noise instead" << std::endl;
+        }
+
+        audio.setSize(2, minimumNumSamples);
+        juce::Random random;
+
+        for (int channel = 0; channel < 2; ++channel)
+            for (int i = 0; i < minimumNumSamples; ++i)
+                audio.setSample(channel, i, random.nextFloat() - 0.5f);
+
+        return audio;
+    }
+
+    void printUsage()
+    {
+        std::cerr << "Usage: TraceReplay <trace.eqtrace> [--audio <file>] [--repeat <count>]" << std::endl;
+    }
+
+    double percentile(const std::vector<double>& sortedValues, double fraction)
+    {
+        const auto index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(sortedValues.size()))) - 1;
+        return sortedValues[juce::jmin(index, sortedValues.size() - 1)];
+    }
+}
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::File traceFile, audioFile;
+    int numRepeats = 1;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String argument(argv[i]);
+        const bool hasValue = i + 1 < argc;
+
+        if (argument == "--help" || argument == "-h")
+        {
+            printUsage();
+            return 0;
+        }
+
+        if (argument == "--audio" && hasValue)
+        {
+            audioFile = juce::File::getCurrentWorkingDirectory().getChildFile(argv[++i]);
+        }
+        else if (argument == "--repeat" && hasValue)
+        {
+            numRepeats = juce::String(argv[++i]).getIntValue();
+
+            if (numRepeats < 1)
+            {
+                std::cerr << "--repeat needs a count of at least 1" << std::endl;
+                printUsage();
+                return 1;
+            }
+        }
+        else if (argument.startsWith("-") || traceFile != juce::File())
+        {
+            // Unknown options, options missing their value and a second trace are all mistakes
+            std::cerr << "Unexpected argument: " << argument << std::endl;
+            printUsage();
+            return 1;
+        }
+        else
+        {
+            traceFile = juce::File::getCurrentWorkingDirectory().getChildFile(argument);
+        }
+    }
+
+    if (traceFile == juce::File())
+    {
+        printUsage();
+        return 1;
+    }
+
+    AutomationTrace trace;
+
+    if (! trace.readFromFile(traceFile) || trace.blocks.empty())
+    {
+        std::cerr << "Could not read a trace from " << traceFile.getFullPathName() << std::endl;
+        return 1;
+    }
+
+    if (trace.truncated)
+        std::cerr << "Warning: the trace is truncated, blocks were dropped during capture" << std::endl;
+
+    int maximumBlockSize = 0;
+
+    for (const auto& block : trace.blocks)
+        maximumBlockSize = juce::jmax(maximumBlockSize, block.numSamples);
+
+    auto input = loadInputAudio(audioFile, maximumBlockSize);
+    juce::AudioBuffer<float> buffer(2, maximumBlockSize);
+    juce::MidiBuffer midiMessages;
+
+    SimpleEQAudioProcessor processor;
+    applyChainSettings(processor.apvts, trace.blocks.front().chainSettings);
+    prepareForOfflineProcessing(processor, trace.sampleRate, maximumBlockSize);
+
+    const auto redesignsBeforeReplay = processor.getNumCoefficientRedesigns();
+
+    std::vector<double> blockMicroseconds;
+    blockMicroseconds.reserve(trace.blocks.size() * static_cast<size_t>(numRepeats));
+
+    int inputPosition = 0;
+
+    for (int repeat = 0; repeat < numRepeats; ++repeat)
+    {
+        for (const auto& block : trace.blocks)
+        {
+            // Parameter changes are the host's work, so they stay outside the timed region
+            applyChainSettings(processor.apvts, block.chainSettings);
+
+            buffer.setSize(2, block.numSamples, false, false, true);
+
+            for (int copied = 0; copied < block.numSamples;)
+            {
+                if (inputPosition >= input.getNumSamples())
+                    inputPosition = 0;
+
+                const auto numToCopy = juce::jmin(block.numSamples - copied, input.getNumSamples() - inputPosition);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    buffer.copyFrom(channel, copied, input, channel, inputPosition, numToCopy);
+
+                copied += numToCopy;
+                inputPosition += numToCopy;
+            }
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+            processor.processBlock(buffer, midiMessages);
+            const auto endTicks = juce::Time::getHighResolutionTicks();
+
+            blockMicroseconds.push_back(juce::Time::highResolutionTicksToSeconds(endTicks - startTicks) * 1.0e6);
+        }
+    }
+
+    processor.releaseResources();
+
+    std::sort(blockMicroseconds.begin(), blockMicroseconds.end());
+
+    std::cout << "Blocks:       " << blockMicroseconds.size()
+              << " (" << trace.blocks.size() << " x " << numRepeats << ") at " << trace.sampleRate << " Hz" << std::endl
+              << "p50:          " << percentile(blockMicroseconds, 0.5) << " us" << std::endl
+              << "p99:          " << percentile(blockMicroseconds, 0.99) << " us" << std::endl
+              << "p99.9:        " << percentile(blockMicroseconds, 0.999) << " us" << std::endl
+              << "max:          " << blockMicroseconds.back() << " us" << std::endl
+              << "Redesigns:    " << (processor.getNumCoefficientRedesigns() - redesignsBeforeReplay) << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    Checks that automation traces survive a round trip and that corrupt or
+    truncated files are rejected instead of crashing the reader.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/AutomationTrace.h"
+
+class AutomationTraceTests  : public juce::UnitTest
+{
+public:
+    AutomationTraceTests() : juce::UnitTest("AutomationTrace", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        AutomationTrace trace;
+        trace.sampleRate = 48000.0;
+        trace.truncated = true;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            AutomationTrace::Block block;
+            block.numSamples = 128 * (i + 1);
+            block.chainSettings.lowCutFreq = 20.f + static_cast<float>(i);
+            block.chainSettings.peakGainInDecibels = -6.f;
+            block.chainSettings.highCutSlope = Slope_36;
+            trace.blocks.push_back(block);
+        }
+
+        juce::MemoryBlock data;
+        {
+            juce::MemoryOutputStream output(data, false);
+            expect(trace.writeToStream(output));
+        }
+
+        beginTest("Round trip");
+        {
+            juce::MemoryInputStream input(data, false);
+            AutomationTrace readBack;
+
+            expect(readBack.readFromStream(input));
+            expectEquals(readBack.sampleRate, trace.sampleRate);
+            expect(readBack.truncated);
+            expectEquals(static_cast<int>(readBack.blocks.size()), 3);
+            expectEquals(readBack.blocks[2].numSamples, 384);
+            expectEquals(readBack.blocks[1].chainSettings.lowCutFreq, 21.f);
+            expect(readBack.blocks[0].chainSettings.highCutSlope == Slope_36);
+        }
+
+        // Offsets into the header: magic, version, sample rate, flags, then the block count
+        constexpr size_t numBlocksOffset = 4 + 4 + 8 + 4;
+        constexpr size_t firstBlockOffset = numBlocksOffset + 4;
+
+        beginTest("Corrupt block count is rejected");
+        {
+            auto corrupt = data;
+            *reinterpret_cast<juce::uint32*>(static_cast<char*>(corrupt.getData()) + numBlocksOffset) = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint32>(0x7fffffff));
+
+            juce::MemoryInputStream input(corrupt, false);
+            expect(! AutomationTrace().readFromStream(input));
+        }
+
+        beginTest("Truncated last block is rejected");
+        {
+            juce::MemoryInputStream input(data.getData(), data.getSize() - 3, false);
+            expect(! AutomationTrace().readFromStream(input));
+        }
+
+        beginTest("Oversized block is rejected");
+        {
+            auto corrupt = data;
+            *reinterpret_cast<juce::uint32*>(static_cast<char*>(corrupt.getData()) + firstBlockOffset) = juce::ByteOrder::swapIfBigEndian(static_cast<juce::uint32>(AutomationTrace::maximumBlockSize + 1));
+
+            juce::MemoryInputStream input(corrupt, false);
+            expect(! AutomationTrace().readFromStream(input));
+        }
+
+        beginTest("Recorder restarts without losing blocks");
+        {
+            AutomationTraceRecorder recorder;
+            recorder.start(48000.0, 8);
+
+            for (int i = 0; i < 6; ++i)
+                recorder.record(48000.0, 64, trace.blocks[0].chainSettings);
+
+            expect(recorder.isNearlyFull());
+
+            const auto first = recorder.restart();
+            expect(recorder.isCapturing());
+            expect(! recorder.isNearlyFull());
+            expectEquals(static_cast<int>(first.blocks.size()), 6);
+            expect(! first.truncated);
+
+            for (int i = 0; i < 10; ++i)
+                recorder.record(48000.0, 64, trace.blocks[0].chainSettings);
+
+            const auto second = recorder.stop();
+            expect(! recorder.isCapturing());
+            expectEquals(static_cast<int>(second.blocks.size()), 8);
+            expect(second.truncated, "blocks beyond the capacity should mark the trace as truncated");
+        }
+    }
+};
+
+static AutomationTraceTests automationTraceTests;
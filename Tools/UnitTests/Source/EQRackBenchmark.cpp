@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    Compares EQRack with the same number of separate SimpleEQAudioProcessor
+    instances, in tracks x samples per second.
+
+  ==============================================================================
+*/
+
+#include "EQRackBenchmark.h"
+#include "../../../Source/PluginProcessor.h"
+
+//==============================================================================
+EQRackThroughput measureEQRackThroughput(const std::vector<ChainSettings>& settings,
+                                         double sampleRate,
+                                         int blockSize,
+                                         int numBlocks)
+{
+    const int numTracksToRun = static_cast<int>(settings.size());
+
+    // Every block starts again from the same noise so both engines see identical input
+    juce::AudioBuffer<float> noise(2, blockSize);
+    juce::Random random;
+
+    for (int channel = 0; channel < 2; ++channel)
+        for (int i = 0; i < blockSize; ++i)
+            noise.setSample(channel, i, random.nextFloat() - 0.5f);
+
+    std::vector<juce::AudioBuffer<float>> buffers(settings.size(), juce::AudioBuffer<float>(2, blockSize));
+    std::vector<juce::AudioBuffer<float>*> bufferPointers;
+
+    for (auto& buffer : buffers)
+        bufferPointers.push_back(&buffer);
+
+    auto refillBuffers = [&buffers, &noise, blockSize]()
+    {
+        for (auto& buffer : buffers)
+            for (int channel = 0; channel < 2; ++channel)
+                buffer.copyFrom(channel, 0, noise, channel, 0, blockSize);
+    };
+
+    auto secondsSince = [](juce::int64 startTicks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    };
+
+    const double totalTrackSamples = static_cast<double>(numTracksToRun) * blockSize * numBlocks;
+    EQRackThroughput throughput;
+
+    auto measureRack = [&](bool redesignEveryBlock)
+    {
+        EQRack rack;
+        rack.prepare(sampleRate, blockSize, numTracksToRun);
+
+        for (int track = 0; track < numTracksToRun; ++track)
+            rack.setTrackSettings(track, settings[static_cast<size_t>(track)]);
+
+        double seconds = 0;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            refillBuffers();
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+
+            if (redesignEveryBlock)
+                for (int track = 0; track < numTracksToRun; ++track)
+                    rack.setTrackSettings(track, settings[static_cast<size_t>(track)]);
+
+            rack.process(bufferPointers.data(), blockSize);
+            seconds += secondsSince(startTicks);
+        }
+
+        return seconds > 0 ? totalTrackSamples / seconds : 0.0;
+    };
+
+    throughput.rackStaticSettings = measureRack(false);
+    throughput.rackRedesigningEveryBlock = measureRack(true);
+
+    {
+        std::vector<std::unique_ptr<SimpleEQAudioProcessor>> processors;
+
+        for (const auto& chainSettings : settings)
+        {
+            auto processor = std::make_unique<SimpleEQAudioProcessor>();
+            applyChainSettings(processor->apvts, chainSettings);
+            prepareForOfflineProcessing(*processor, sampleRate, blockSize);
+
+            processors.push_back(std::move(processor));
+        }
+
+        juce::MidiBuffer midiMessages;
+        double seconds = 0;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            refillBuffers();
+
+            const auto startTicks = juce::Time::getHighResolutionTicks();
+
+            for (size_t track = 0; track < processors.size(); ++track)
+                processors[track]->processBlock(buffers[track], midiMessages);
+
+            seconds += secondsSince(startTicks);
+        }
+
+        if (seconds > 0)
+            throughput.separateProcessors = totalTrackSamples / seconds;
+    }
+
+    return throughput;
+}
@@ -0,0 +1,34 @@
+/*
+  ==============================================================================
+
+    Compares EQRack with the same number of separate SimpleEQAudioProcessor
+    instances, in tracks x samples per second.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../../Source/EQRack.h"
+
+struct EQRackThroughput
+{
+    // All figures are in tracks x samples per second
+    double rackStaticSettings { 0 };
+    double rackRedesigningEveryBlock { 0 };
+    double separateProcessors { 0 };
+};
+
+/* Runs settings.size() tracks of noise through a rack and through the same
+   number of SimpleEQAudioProcessor instances for numBlocks blocks.
+   The processors redesign their coefficients every block as they do in
+   processBlock(). The rack is measured twice: designing once up front, and
+   calling setTrackSettings() for every track before every block, which is
+   the like-for-like comparison with the processors.
+   Needs a JUCE message manager (e.g. juce::ScopedJuceInitialiser_GUI)
+   because each processor owns an AudioProcessorValueTreeState */
+EQRackThroughput measureEQRackThroughput(const std::vector<ChainSettings>& settings,
+                                         double sampleRate,
+                                         int blockSize,
+                                         int numBlocks);
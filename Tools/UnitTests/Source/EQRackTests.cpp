@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    Checks that every EQRack track sounds exactly like a SimpleEQAudioProcessor
+    with the same ChainSettings, including when the settings change between
+    blocks, and logs the rack's throughput.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../../Source/EQRack.h"
+#include "../../../Source/PluginProcessor.h"
+#include "EQRackBenchmark.h"
+
+class EQRackTests  : public juce::UnitTest
+{
+public:
+    EQRackTests() : juce::UnitTest("EQRack", "SimpleEQ") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 256;
+        constexpr int numBlocks = 12;
+
+        // Fills a whole group plus part of the next one
+        const int numTracks = EQRack::lanesPerGroup + 3;
+        const int bypassedTrack = 2;
+
+        beginTest("Tracks match SimpleEQAudioProcessor");
+        {
+            std::vector<std::unique_ptr<SimpleEQAudioProcessor>> processors;
+            EQRack rack;
+            rack.prepare(sampleRate, blockSize, numTracks);
+
+            for (int track = 0; track < numTracks; ++track)
+            {
+                auto processor = std::make_unique<SimpleEQAudioProcessor>();
+                applyChainSettings(processor->apvts, makeSettings(track));
+                prepareForOfflineProcessing(*processor, sampleRate, blockSize);
+
+                // Read back so both engines use the values the parameters snapped to
+                rack.setTrackSettings(track, getChainSettings(processor->apvts));
+                processors.push_back(std::move(processor));
+            }
+
+            rack.setTrackBypassed(bypassedTrack, true);
+            expect(rack.isTrackBypassed(bypassedTrack));
+
+            juce::Random random(42);
+            juce::MidiBuffer midiMessages;
+            std::vector<juce::AudioBuffer<float>> rackBuffers(static_cast<size_t>(numTracks), juce::AudioBuffer<float>(2, blockSize));
+            std::vector<juce::AudioBuffer<float>*> rackBufferPointers;
+
+            for (auto& buffer : rackBuffers)
+                rackBufferPointers.push_back(&buffer);
+
+            float maximumError = 0.f;
+
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                // Lower every slope, then raise it again, so bypassed links come back with their old state
+                if (block == 4 || block == 8)
+                {
+                    for (int track = 0; track < numTracks; ++track)
+                    {
+                        auto& processor = *processors[static_cast<size_t>(track)];
+                        applyChainSettings(processor.apvts, makeSettings(track, block));
+                        rack.setTrackSettings(track, getChainSettings(processor.apvts));
+                    }
+                }
+
+                std::vector<juce::AudioBuffer<float>> inputs;
+
+                for (auto& buffer : rackBuffers)
+                {
+                    for (int channel = 0; channel < 2; ++channel)
+                        for (int i = 0; i < blockSize; ++i)
+                            buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+                    inputs.push_back(buffer);
+                }
+
+                rack.process(rackBufferPointers.data(), blockSize);
+
+                for (int track = 0; track < numTracks; ++track)
+                {
+                    const auto& input = inputs[static_cast<size_t>(track)];
+                    const auto& rackOutput = rackBuffers[static_cast<size_t>(track)];
+
+                    if (track == bypassedTrack)
+                    {
+                        for (int channel = 0; channel < 2; ++channel)
+                            for (int i = 0; i < blockSize; ++i)
+                                expectEquals(rackOutput.getSample(channel, i), input.getSample(channel, i));
+
+                        continue;
+                    }
+
+                    auto processorOutput = input;
+                    processors[static_cast<size_t>(track)]->processBlock(processorOutput, midiMessages);
+
+                    for (int channel = 0; channel < 2; ++channel)
+                        for (int i = 0; i < blockSize; ++i)
+                            maximumError = juce::jmax(maximumError, std::abs(rackOutput.getSample(channel, i) - processorOutput.getSample(channel, i)));
+                }
+            }
+
+            // The rack may fuse multiply-adds (FMA), so allow for rounding differences
+            expectLessThan(maximumError, 1.0e-4f, "largest difference between rack and processor");
+        }
+
+        beginTest("Blocks longer than maximumBlockSize are processed in chunks");
+        {
+            constexpr int longBlockSize = 3 * blockSize + 17;
+
+            EQRack chunkedRack, wholeRack;
+            chunkedRack.prepare(sampleRate, blockSize, numTracks);
+            wholeRack.prepare(sampleRate, longBlockSize, numTracks);
+
+            for (int track = 0; track < numTracks; ++track)
+            {
+                chunkedRack.setTrackSettings(track, makeSettings(track));
+                wholeRack.setTrackSettings(track, makeSettings(track));
+            }
+
+            juce::Random random(7);
+            std::vector<juce::AudioBuffer<float>> chunkedBuffers, wholeBuffers;
+
+            for (int track = 0; track < numTracks; ++track)
+            {
+                juce::AudioBuffer<float> buffer(2, longBlockSize);
+
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < longBlockSize; ++i)
+                        buffer.setSample(channel, i, random.nextFloat() - 0.5f);
+
+                chunkedBuffers.push_back(buffer);
+                wholeBuffers.push_back(buffer);
+            }
+
+            std::vector<juce::AudioBuffer<float>*> chunkedPointers, wholePointers;
+
+            for (int track = 0; track < numTracks; ++track)
+            {
+                chunkedPointers.push_back(&chunkedBuffers[static_cast<size_t>(track)]);
+                wholePointers.push_back(&wholeBuffers[static_cast<size_t>(track)]);
+            }
+
+            chunkedRack.process(chunkedPointers.data(), longBlockSize);
+            wholeRack.process(wholePointers.data(), longBlockSize);
+
+            // The recurrence runs sample by sample either way, so chunking is exact
+            bool identical = true;
+
+            for (int track = 0; track < numTracks; ++track)
+                for (int channel = 0; channel < 2; ++channel)
+                    for (int i = 0; i < longBlockSize; ++i)
+                        identical = identical && chunkedBuffers[static_cast<size_t>(track)].getSample(channel, i)
+                                                    == wholeBuffers[static_cast<size_t>(track)].getSample(channel, i);
+
+            expect(identical, "chunked output differs from unchunked output");
+        }
+
+        beginTest("Throughput");
+        {
+            std::vector<ChainSettings> settings;
+
+            for (int track = 0; track < 4 * EQRack::lanesPerGroup; ++track)
+                settings.push_back(makeSettings(track));
+
+            const auto throughput = measureEQRackThroughput(settings, sampleRate, blockSize, 200);
+
+            logMessage("Tracks x samples/sec for " + juce::String(settings.size()) + " tracks:");
+            logMessage("  rack, static settings:        " + juce::String(throughput.rackStaticSettings, 0));
+            logMessage("  rack, redesign every block:   " + juce::String(throughput.rackRedesigningEveryBlock, 0));
+            logMessage("  separate processors:          " + juce::String(throughput.separateProcessors, 0));
+
+            expectGreaterThan(throughput.rackStaticSettings, 0.0);
+            expectGreaterThan(throughput.rackRedesigningEveryBlock, 0.0);
+            expectGreaterThan(throughput.separateProcessors, 0.0);
+        }
+    }
+
+private:
+    /* Cycles through every slope and a spread of frequencies, gains and Qs.
+       From block 4 every slope drops to 12 dB/Oct, from block 8 it rises to 48 */
+    static ChainSettings makeSettings(int track, int block = 0)
+    {
+        ChainSettings settings;
+        settings.lowCutFreq = static_cast<float>(40 + 30 * (track % 5));
+        settings.highCutFreq = static_cast<float>(6000 + 1500 * (track % 6));
+        settings.peakFreq = static_cast<float>(300 + 250 * (track % 7));
+        settings.peakGainInDecibels = -12.f + 3.f * static_cast<float>(track % 9);
+        settings.peakQuality = 0.5f + 0.5f * static_cast<float>(track % 4);
+        settings.lowCutSlope = static_cast<Slope>(track % 4);
+        settings.highCutSlope = static_cast<Slope>((track / 4) % 4);
+
+        if (block >= 8)
+        {
+            settings.lowCutSlope = Slope_48;
+            settings.highCutSlope = Slope_48;
+        }
+        else if (block >= 4)
+        {
+            settings.lowCutSlope = Slope_12;
+            settings.highCutSlope = Slope_12;
+            settings.peakGainInDecibels = -settings.peakGainInDecibels;
+        }
+
+        return settings;
+    }
+};
+
+static EQRackTests eqRackTests;
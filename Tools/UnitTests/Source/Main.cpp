@@ -0,0 +1,30 @@
+/*
+  ==============================================================================
+
+    Runs every juce::UnitTest compiled into this app and returns the number of
+    failed expectations as the exit code.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ignoreUnused(argc, argv);
+
+    // The processors under test own an AudioProcessorValueTreeState, which needs the message manager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runTestsInCategory("SimpleEQ");
+
+    int numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult(i)->failures;
+
+    return numFailures;
+}